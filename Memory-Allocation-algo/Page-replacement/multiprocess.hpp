@@ -0,0 +1,491 @@
+#ifndef MULTIPROCESS_HPP
+#define MULTIPROCESS_HPP
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "page_replacement.hpp"
+
+// 多进程共享帧池
+
+enum class ReplaceScope {
+    Local_scope,
+    Global_scope,
+};
+
+enum class FrameAlloc {
+    Equal_alloc,
+    Working_set_alloc,
+    Pff_alloc,
+};
+
+struct ProcessTrace {
+    int pid;
+    std::vector<PageId> refs;
+};
+
+// alloc 只决定 Local_scope 下各进程分区的大小；Global_scope 始终共用整个帧池
+struct MultiConfig {
+    ReplaceAlgo algo       = ReplaceAlgo::Lru_algo;
+    int poolFrames         = 12;
+    int quantum            = 4;
+    ReplaceScope scope     = ReplaceScope::Local_scope;
+    FrameAlloc alloc       = FrameAlloc::Equal_alloc;
+    int wsWindow           = 10;
+    int controlInterval    = 8;
+    double pffLower        = 0.1;
+    double pffUpper        = 0.4;
+    double thrashFaultRate = 0.5;
+};
+
+struct ProcessStats {
+    int pid;
+    int refs        = 0;
+    int faults      = 0;
+    int suspensions = 0;
+    int minFrames   = 0;
+    int maxFrames   = 0;
+};
+
+struct WindowStats {
+    int start;
+    int refs;
+    int faults;
+    int coldFaults;
+    int wsDemand;
+    int active;   // 本窗口内实际执行过引用的进程数
+    bool thrashing;
+};
+
+struct MultiResult {
+    std::vector<ProcessStats> procs;
+    std::vector<WindowStats> windows;
+};
+
+class WorkingSet {
+    std::size_t window_;
+    std::deque<PageId> recent_;
+    std::unordered_map<PageId, int> counts_;
+
+public:
+    explicit WorkingSet(int window) : window_(static_cast<std::size_t>(std::max(1, window))) {}
+
+    void touch(PageId page) {
+        recent_.push_back(page);
+        ++counts_[page];
+        if (recent_.size() > window_) {
+            PageId old = recent_.front();
+            recent_.pop_front();
+            if (--counts_[old] == 0) counts_.erase(old);
+        }
+    }
+
+    int size() const { return static_cast<int>(counts_.size()); }
+};
+
+struct ProcessCtx {
+    const ProcessTrace* trace;
+    std::size_t next = 0;
+    std::vector<Frame> frames;
+    std::unique_ptr<AlgoState> state;
+    std::unordered_map<PageId, int> lastUse;
+    std::unordered_map<PageId, int> loadedAt;
+    WorkingSet ws;
+    bool suspended   = false;
+    int windowRefs   = 0;
+    int windowFaults = 0;
+    ProcessStats stats;
+
+    ProcessCtx(const ProcessTrace& t, int wsWindow) : trace(&t), ws(wsWindow), stats{t.pid} {}
+
+    bool finished() const { return next >= trace->refs.size(); }
+    int frameCount() const { return static_cast<int>(frames.size()); }
+};
+
+inline void noteFrames(ProcessStats& stats, int frameCount) {
+    if (frameCount <= 0) return;
+    if (stats.maxFrames == 0 || frameCount < stats.minFrames) stats.minFrames = frameCount;
+    stats.maxFrames = std::max(stats.maxFrames, frameCount);
+}
+
+// 重建分区：驻留页经 replayResident() 回放装入新的 AlgoState
+inline void resizePartition(ProcessCtx& p, ReplaceAlgo algo, int frameCount) {
+    if (frameCount == p.frameCount()) return;
+
+    std::vector<ResidentPage> resident;
+    for (const auto& [page, valid, dirty] : p.frames) {
+        if (valid) resident.push_back(ResidentPage{page, p.loadedAt[page], p.lastUse[page]});
+    }
+    p.state = replayResident(algo, frameCount, resident, p.frames, p.trace->refs);
+    noteFrames(p.stats, frameCount);
+}
+
+// 冷启动缺页不计入缺页率，避免把装入阶段误判为抖动
+inline bool windowThrashing(const WindowStats& w, const MultiConfig& cfg) {
+    double rate = w.refs ? static_cast<double>(w.faults - w.coldFaults) / w.refs : 0.0;
+    return rate >= cfg.thrashFaultRate || w.wsDemand > cfg.poolFrames;
+}
+
+inline MultiResult simulateLocal(const std::vector<ProcessTrace>& traces, const MultiConfig& cfg) {
+    const int n = static_cast<int>(traces.size());
+    std::vector<ProcessCtx> procs;
+    procs.reserve(traces.size());
+    for (int i = 0; i < n; ++i) {
+        procs.emplace_back(traces[i], cfg.wsWindow);
+        int share = cfg.poolFrames / n + (i < cfg.poolFrames % n ? 1 : 0);
+        resizePartition(procs[i], cfg.algo, share);
+    }
+
+    MultiResult result;
+    WindowStats window{0, 0, 0, 0, 0, n, false};
+
+    auto control = [&](int tick) {
+        int demand       = 0;
+        int active       = 0;
+        int windowActive = 0;
+        for (const auto& p : procs) {
+            if (p.windowRefs > 0 || (!p.suspended && !p.finished())) demand += p.ws.size();
+            if (p.windowRefs > 0) ++windowActive;
+            if (!p.suspended && !p.finished()) ++active;
+        }
+        window.wsDemand  = demand;
+        window.active    = windowActive;
+        window.thrashing = windowThrashing(window, cfg);
+        if (window.refs > 0) result.windows.push_back(window);
+        window = WindowStats{tick, 0, 0, 0, 0, active, false};
+
+        if (cfg.alloc == FrameAlloc::Equal_alloc) {
+            for (auto& p : procs) {
+                p.windowRefs   = 0;
+                p.windowFaults = 0;
+            }
+            return;
+        }
+
+        std::vector<int> desired(n, 0);
+        for (int i = 0; i < n; ++i) {
+            auto& p = procs[i];
+            if (p.suspended || p.finished()) continue;
+            if (cfg.alloc == FrameAlloc::Working_set_alloc) {
+                desired[i] = std::max(1, p.ws.size());
+            } else {
+                desired[i] = std::max(1, p.frameCount());
+                if (p.windowRefs > 0) {
+                    double rate = static_cast<double>(p.windowFaults) / p.windowRefs;
+                    if (rate > cfg.pffUpper) ++desired[i];
+                    else if (rate < cfg.pffLower && desired[i] > 1) --desired[i];
+                }
+            }
+            desired[i] = std::min(desired[i], cfg.poolFrames);
+        }
+        for (auto& p : procs) {
+            p.windowRefs   = 0;
+            p.windowFaults = 0;
+        }
+
+        // 负载控制：需求超出帧池时挂起需求最大的进程，直至剩余进程都能容纳
+        auto total = [&] {
+            int sum = 0;
+            for (int d : desired) sum += d;
+            return sum;
+        };
+        std::vector<bool> justSuspended(n, false);
+        while (total() > cfg.poolFrames && active > 1) {
+            int victim = -1;
+            for (int i = 0; i < n; ++i) {
+                if (desired[i] > 0 && (victim == -1 || desired[i] >= desired[victim])) victim = i;
+            }
+            procs[victim].suspended = true;
+            justSuspended[victim]   = true;
+            ++procs[victim].stats.suspensions;
+            desired[victim] = 0;
+            --active;
+        }
+
+        for (int i = 0; i < n; ++i) {
+            if (!procs[i].suspended) resizePartition(procs[i], cfg.algo, desired[i]);
+        }
+
+        int freeFrames = cfg.poolFrames - total();
+        for (int i = 0; i < n; ++i) {
+            auto& p = procs[i];
+            if (!p.suspended || p.finished() || justSuspended[i]) continue;
+            int need = cfg.alloc == FrameAlloc::Working_set_alloc
+                               ? std::max(1, p.ws.size())
+                               : std::max(1, cfg.poolFrames / n);
+            if (active == 0) need = std::min(need, freeFrames);
+            if (need > freeFrames) continue;
+            p.suspended = false;
+            p.frames.clear();
+            p.state.reset();
+            resizePartition(p, cfg.algo, need);
+            freeFrames -= need;
+            ++active;
+        }
+
+        for (auto& p : procs) {
+            if (p.suspended) resizePartition(p, cfg.algo, 0);
+        }
+    };
+
+    int tick        = 0;
+    std::size_t cur = 0;
+    while (true) {
+        int runnable  = -1;
+        bool anyAlive = false;
+        for (int k = 0; k < n; ++k) {
+            int i = static_cast<int>((cur + k) % n);
+            if (procs[i].finished()) continue;
+            anyAlive = true;
+            if (!procs[i].suspended) {
+                runnable = i;
+                break;
+            }
+        }
+        if (!anyAlive) break;
+        if (runnable == -1) {
+            control(tick);
+            continue;
+        }
+
+        auto& p = procs[runnable];
+        for (int q = 0; q < cfg.quantum && !p.finished() && !p.suspended; ++q) {
+            int step = static_cast<int>(p.next);
+            PageId page = p.trace->refs[p.next++];
+            auto [hit, victim] = p.state->access(step, page, p.frames, p.trace->refs);
+            bool cold          = p.lastUse.find(page) == p.lastUse.end();
+            p.lastUse[page]    = step;
+            p.ws.touch(page);
+            ++p.stats.refs;
+            ++p.windowRefs;
+            ++window.refs;
+            if (!hit) {
+                p.loadedAt[page] = step;
+                ++p.stats.faults;
+                ++p.windowFaults;
+                ++window.faults;
+                if (cold) ++window.coldFaults;
+            }
+            if (++tick % cfg.controlInterval == 0) control(tick);
+        }
+        cur = (runnable + 1) % n;
+    }
+    control(tick);
+
+    for (const auto& p : procs) result.procs.push_back(p.stats);
+    return result;
+}
+
+inline MultiResult simulateGlobal(const std::vector<ProcessTrace>& traces, const MultiConfig& cfg) {
+    const int n = static_cast<int>(traces.size());
+
+    // 按时间片轮转展开为全局引用串，(pid, page) 映射为全局唯一的页号
+    std::map<std::pair<int, PageId>, PageId> keyIds;
+    std::vector<int> keyOwner;
+    std::vector<PageId> keyRef;
+    std::vector<int> owner;
+    std::vector<std::size_t> next(n, 0);
+    for (bool progress = true; progress;) {
+        progress = false;
+        for (int i = 0; i < n; ++i) {
+            for (int q = 0; q < cfg.quantum && next[i] < traces[i].refs.size(); ++q) {
+                auto key = std::make_pair(i, traces[i].refs[next[i]++]);
+                auto it  = keyIds.find(key);
+                if (it == keyIds.end()) {
+                    it = keyIds.emplace(key, static_cast<PageId>(keyOwner.size())).first;
+                    keyOwner.push_back(i);
+                }
+                keyRef.push_back(it->second);
+                owner.push_back(i);
+                progress = true;
+            }
+        }
+    }
+
+    std::vector<Frame> frames(cfg.poolFrames);
+    auto state = newAlgoState(cfg.algo, cfg.poolFrames);
+    std::vector<WorkingSet> ws(n, WorkingSet(cfg.wsWindow));
+    std::vector<std::size_t> remaining(n);
+    std::vector<int> windowRefs(n, 0);
+    std::vector<bool> seen(keyOwner.size(), false);
+    MultiResult result;
+    for (int i = 0; i < n; ++i) {
+        result.procs.push_back(ProcessStats{traces[i].pid});
+        remaining[i] = traces[i].refs.size();
+    }
+    WindowStats window{0, 0, 0, 0, 0, n, false};
+
+    auto control = [&](int tick) {
+        std::vector<int> resident(n, 0);
+        for (const auto& [page, valid, dirty] : frames) {
+            if (valid) ++resident[keyOwner[page]];
+        }
+        int demand       = 0;
+        int active       = 0;
+        int windowActive = 0;
+        for (int i = 0; i < n; ++i) {
+            if (windowRefs[i] > 0 || remaining[i] > 0) demand += ws[i].size();
+            if (windowRefs[i] > 0) ++windowActive;
+            windowRefs[i] = 0;
+            if (remaining[i] == 0) continue;
+            noteFrames(result.procs[i], resident[i]);
+            ++active;
+        }
+        window.wsDemand  = demand;
+        window.active    = windowActive;
+        window.thrashing = windowThrashing(window, cfg);
+        if (window.refs > 0) result.windows.push_back(window);
+        window = WindowStats{tick, 0, 0, 0, 0, active, false};
+    };
+
+    for (std::size_t step = 0; step < keyRef.size(); ++step) {
+        int i = owner[step];
+        auto [hit, victim] = state->access(static_cast<int>(step), keyRef[step], frames, keyRef);
+        ws[i].touch(keyRef[step]);
+        --remaining[i];
+        ++windowRefs[i];
+        ++result.procs[i].refs;
+        ++window.refs;
+        if (!hit) {
+            ++result.procs[i].faults;
+            ++window.faults;
+            if (!seen[keyRef[step]]) ++window.coldFaults;
+        }
+        seen[keyRef[step]] = true;
+        if ((step + 1) % cfg.controlInterval == 0) control(static_cast<int>(step + 1));
+    }
+    control(static_cast<int>(keyRef.size()));
+    return result;
+}
+
+inline MultiResult simulateMulti(const std::vector<ProcessTrace>& traces, const MultiConfig& cfg) {
+    if (traces.empty() || cfg.poolFrames <= 0 || cfg.quantum <= 0 || cfg.controlInterval <= 0) return {};
+    if (cfg.scope == ReplaceScope::Global_scope) return simulateGlobal(traces, cfg);
+    if (cfg.poolFrames < static_cast<int>(traces.size())) return {};
+    return simulateLocal(traces, cfg);
+}
+
+inline std::string scopeName(ReplaceScope scope) {
+    return scope == ReplaceScope::Global_scope ? "Global" : "Local";
+}
+
+inline std::string frameAllocName(FrameAlloc alloc) {
+    switch (alloc) {
+        case FrameAlloc::Equal_alloc: return "Equal";
+        case FrameAlloc::Working_set_alloc: return "Working-Set";
+        case FrameAlloc::Pff_alloc: return "PFF";
+    }
+    return "Unknown";
+}
+
+inline void printMultiResults(const MultiResult& result) {
+    using std::cout;
+    using std::left;
+    using std::setw;
+
+    if (result.procs.empty()) {
+        cout << "Invalid configuration: need at least one process and one frame per local partition.\n";
+        return;
+    }
+
+    cout << left
+            << setw(6) << "PID"
+            << setw(8) << "Refs"
+            << setw(8) << "Faults"
+            << setw(12) << "Fault Rate"
+            << setw(10) << "Frames"
+            << "Suspended\n";
+    cout << std::string(60, '-') << "\n";
+
+    int refs   = 0;
+    int faults = 0;
+    for (const auto& [pid, r, f, suspensions, minFrames, maxFrames] : result.procs) {
+        refs += r;
+        faults += f;
+        cout << left
+                << setw(6) << pid
+                << setw(8) << r
+                << setw(8) << f
+                << setw(12) << (r ? static_cast<double>(f) / r : 0.0)
+                << setw(10) << (std::to_string(minFrames) + "-" + std::to_string(maxFrames))
+                << suspensions << "\n";
+    }
+
+    cout << "\n"
+            << left
+            << setw(8) << "Start"
+            << setw(8) << "Refs"
+            << setw(8) << "Faults"
+            << setw(8) << "Cold"
+            << setw(10) << "WS Need"
+            << setw(8) << "Active"
+            << "Thrashing\n";
+    cout << std::string(60, '-') << "\n";
+
+    int thrashing   = 0;
+    int firstThrash = -1;
+    for (const auto& [start, r, f, cold, demand, active, thrash] : result.windows) {
+        if (thrash) {
+            ++thrashing;
+            if (firstThrash == -1) firstThrash = start;
+        }
+        cout << left
+                << setw(8) << start
+                << setw(8) << r
+                << setw(8) << f
+                << setw(8) << cold
+                << setw(10) << demand
+                << setw(8) << active
+                << (thrash ? "Yes" : "No") << "\n";
+    }
+
+    cout << "\nTotal Refs: " << refs << ", Faults: " << faults
+            << ", Fault Rate: " << (refs ? static_cast<double>(faults) / refs : 0.0)
+            << "\nThrashing windows: " << thrashing << "/" << result.windows.size();
+    if (firstThrash >= 0) cout << " (first at ref " << firstThrash << ")";
+    cout << "\n";
+}
+
+inline void runMultiTests() {
+    using std::cout;
+
+    const std::vector<ProcessTrace> traces = {
+            {1, {1, 2, 3, 1, 2, 3, 1, 2, 3, 4, 1, 2, 3, 4, 1, 2}},
+            {2, {5, 6, 7, 8, 9, 5, 6, 7, 8, 9, 5, 6, 7, 8, 9, 5}},
+            {3, {1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2, 1, 1, 2, 2}},
+    };
+
+    struct MultiCase {
+        ReplaceScope scope;
+        FrameAlloc alloc;
+        int pool;
+    };
+    const std::vector<MultiCase> cases = {
+            {ReplaceScope::Local_scope, FrameAlloc::Equal_alloc, 9},
+            {ReplaceScope::Global_scope, FrameAlloc::Equal_alloc, 9},
+            {ReplaceScope::Local_scope, FrameAlloc::Working_set_alloc, 9},
+            {ReplaceScope::Local_scope, FrameAlloc::Pff_alloc, 6},
+    };
+
+    for (const auto& [scope, alloc, pool] : cases) {
+        MultiConfig cfg;
+        cfg.scope      = scope;
+        cfg.alloc      = alloc;
+        cfg.poolFrames = pool;
+        cfg.wsWindow   = 8;
+        cout << "\nTest: " << traces.size() << " processes, " << scopeName(scope) << " LRU, "
+                << frameAllocName(alloc) << " allocation, pool " << pool
+                << ", quantum " << cfg.quantum << "\n";
+        printMultiResults(simulateMulti(traces, cfg));
+    }
+}
+
+#endif
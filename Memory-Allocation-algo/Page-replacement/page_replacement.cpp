@@ -5,203 +5,19 @@
 #include <sstream>
 #include <string>
 #include <vector>
-using namespace std;
-
-enum class ReplaceAlgo {
-    Fifo_algo,
-    Opt_algo,
-    Lru_algo,
-};
-
-struct Frame {
-    int page   = 0;
-    bool valid = false;
-};
-
-struct AccessRes {
-    bool hit;
-    std::size_t victim;
-
-    AccessRes(const bool h, const std::size_t v) : hit(h), victim(v) {}
-    AccessRes(const bool h, const int intV) : hit(h), victim(static_cast<std::size_t>(intV)) {}
-};
-
-class AlgoState {
-public:
-    virtual ~AlgoState() = default;
-    virtual AccessRes access(int step, int page, vector<Frame>& frames, const vector<int>& ref) = 0;
-};
-
-class FifoState final : public AlgoState {
-    int nextIndex_;
-
-public:
-    explicit FifoState(int /*frameCount*/) : nextIndex_(0) {}
-
-    AccessRes access(int /*step*/, int page, vector<Frame>& frames, const vector<int>& /*ref*/) override {
-        for (const auto& [p, valid] : frames) {
-            if (valid && p == page) {
-                return {true, -1};
-            }
-        }
-
-        for (std::size_t i = 0; i < frames.size(); ++i) {
-            if (!frames[i].valid) {
-                frames[i].page  = page;
-                frames[i].valid = true;
-                return {false, i};
-            }
-        }
-
-        int victim           = nextIndex_;
-        nextIndex_           = (nextIndex_ + 1) % static_cast<int>(frames.size());
-        frames[victim].page  = page;
-        frames[victim].valid = true;
-        return {false, victim};
-    }
-};
-
-class LruState final : public AlgoState {
-    vector<int> lastUsed_;
-
-public:
-    explicit LruState(int frameCount) : lastUsed_(frameCount, -1) {}
-
-    AccessRes access(int step, int page, vector<Frame>& frames, const vector<int>& /*ref*/) override {
-        for (std::size_t i = 0; i < frames.size(); ++i) {
-            if (frames[i].valid && frames[i].page == page) {
-                lastUsed_[i] = step;
-                return {true, -1};
-            }
-        }
-
-        for (std::size_t i = 0; i < frames.size(); ++i) {
-            if (!frames[i].valid) {
-                frames[i].page  = page;
-                frames[i].valid = true;
-                lastUsed_[i]    = step;
-                return {false, i};
-            }
-        }
 
-        int victim = 0;
-        int oldest = lastUsed_[0];
-        for (std::size_t i = 1; i < frames.size(); ++i) {
-            if (lastUsed_[i] < oldest) {
-                oldest = lastUsed_[i];
-                victim = static_cast<int>(i);
-            }
-        }
-
-        frames[victim].page  = page;
-        frames[victim].valid = true;
-        lastUsed_[victim]    = step;
-        return AccessRes{false, victim};
-    }
-};
-
-class OptState final : public AlgoState {
-public:
-    explicit OptState(int /*frameCount*/) {}
-
-    AccessRes access(int step, int page, vector<Frame>& frames, const vector<int>& ref) override {
-        for (const auto& [p, valid] : frames) {
-            if (valid && p == page) {
-                return {true, -1};
-            }
-        }
-
-        for (std::size_t i = 0; i < frames.size(); ++i) {
-            if (!frames[i].valid) {
-                frames[i].page  = page;
-                frames[i].valid = true;
-                return {false, static_cast<int>(i)};
-            }
-        }
-
-        int victim          = -1;
-        int farthestNextUse = -1;
-
-        for (std::size_t i = 0; i < frames.size(); ++i) {
-            int nextUse = -1;
-            for (std::size_t j = step + 1; j < ref.size(); ++j) {
-                if (ref[j] == frames[i].page) {
-                    nextUse = static_cast<int>(j);
-                    break;
-                }
-            }
-
-            if (nextUse == -1) {
-                victim = static_cast<int>(i);
-                break;
-            }
-
-            if (nextUse > farthestNextUse) {
-                farthestNextUse = nextUse;
-                victim          = static_cast<int>(i);
-            }
-        }
-
-        if (victim == -1) {
-            victim = 0;
-        }
-
-        frames[victim].page  = page;
-        frames[victim].valid = true;
-        return {false, victim};
-    }
-};
-
-unique_ptr<AlgoState> newAlgoState(ReplaceAlgo algo, int frameCount) {
-    switch (algo) {
-        case ReplaceAlgo::Fifo_algo:
-            return make_unique<FifoState>(frameCount);
-        case ReplaceAlgo::Opt_algo:
-            return make_unique<OptState>(frameCount);
-        case ReplaceAlgo::Lru_algo:
-            return make_unique<LruState>(frameCount);
-        default:
-            return make_unique<FifoState>(frameCount);
-    }
-}
-
-struct StepResult {
-    int step;
-    int page;
-    bool hit;
-    std::size_t victim;
-    vector<Frame> frames;
-};
-
-vector<StepResult> simulate(ReplaceAlgo algo, int frameCount, const vector<int>& ref) {
-    vector<Frame> frames(frameCount);
-    auto state = newAlgoState(algo, frameCount);
-    vector<StepResult> results;
-    results.reserve(ref.size());
-
-    for (std::size_t step = 0; step < ref.size(); ++step) {
-        auto [hit, victim] = state->access(static_cast<int>(step), ref[step], frames, ref);
-        results.push_back(StepResult{static_cast<int>(step), ref[step], hit, victim, frames,});
-    }
-
-    return results;
-}
-
-string algoName(ReplaceAlgo algo) {
-    switch (algo) {
-        case ReplaceAlgo::Fifo_algo: return "FIFO";
-        case ReplaceAlgo::Opt_algo: return "OPT";
-        case ReplaceAlgo::Lru_algo: return "LRU";
-    }
-    return "Unknown";
-}
+#include "page_replacement.hpp"
+#include "multiprocess.hpp"
+#include "prefetch.hpp"
+#include "shards.hpp"
+using namespace std;
 
 string frameSnapshot(const vector<Frame>& frames) {
     ostringstream oss;
     oss << "[";
     for (std::size_t i = 0; i < frames.size(); ++i) {
         if (i) oss << " | ";
-        if (frames[i].valid) oss << frames[i].page;
+        if (frames[i].valid) oss << frames[i].page << (frames[i].dirty ? "*" : "");
         else oss << "-";
     }
     oss << "]";
@@ -209,30 +25,53 @@ string frameSnapshot(const vector<Frame>& frames) {
 }
 
 void printResults(const vector<StepResult>& results) {
-    int hits   = 0;
-    int faults = 0;
+    int hits         = 0;
+    int faults       = 0;
+    int writeIos     = 0;
+    int pagesWritten = 0;
+
+    // 页号列随最长页号加宽，64 位页号也不会与后续列粘连
+    int pageWidth = 8;
+    for (const auto& step : results) {
+        pageWidth = max(pageWidth, static_cast<int>(to_string(step.page).size()) + 2);
+    }
 
     cout << left
             << setw(6) << "Step"
-            << setw(8) << "Page"
+            << setw(pageWidth) << "Page"
             << setw(8) << "Hit?"
             << setw(10) << "Victim"
+            << setw(6) << "WB"
             << "Frames\n";
     cout << string(60, '-') << "\n";
 
-    for (const auto& [step, page, hit, victim, frames] : results) {
+    for (const auto& [step, page, op, hit, victim, written, frames] : results) {
         if (hit) ++hits;
         else ++faults;
+        if (written) {
+            ++writeIos;
+            pagesWritten += written;
+        }
         cout << left
                 << setw(6) << step
-                << setw(8) << page
+                << setw(pageWidth) << (to_string(page) + (op == AccessOp::Write_op ? "w" : ""))
                 << setw(8) << (hit ? "Yes" : "No")
-                << setw(10) << (victim >= 0 ? to_string(victim) : "-")
+                << setw(10) << (hit ? "-" : to_string(victim))
+                << setw(6) << (written ? to_string(written) : "-")
                 << frameSnapshot(frames) << "\n";
     }
 
+    int dirtyAtEnd = 0;
+    if (!results.empty()) {
+        for (const auto& [page, valid, dirty] : results.back().frames) {
+            if (valid && dirty) ++dirtyAtEnd;
+        }
+    }
+
     cout << "\nHits: " << hits << ", Faults: " << faults
             << ", Hit Ratio: " << (results.empty() ? 0.0 : static_cast<double>(hits) / results.size())
+            << "\nWrite-back I/Os: " << writeIos << ", Pages written: " << pagesWritten
+            << ", Dirty at end: " << dirtyAtEnd
             << "\n";
 }
 
@@ -241,15 +80,22 @@ ReplaceAlgo selectAlgo(int choice) {
         case 1: return ReplaceAlgo::Fifo_algo;
         case 2: return ReplaceAlgo::Opt_algo;
         case 3: return ReplaceAlgo::Lru_algo;
+        case 7: return ReplaceAlgo::Clock_algo;
+        case 8: return ReplaceAlgo::Clean_clock_algo;
         default: return ReplaceAlgo::Fifo_algo;
     }
 }
 
+// 多进程、预读与 SHARDS 的引用串不带读写标记，脏位恒为假，因此不提供 Clean-first CLOCK
+ReplaceAlgo selectReadOnlyAlgo(int choice) {
+    return choice == 8 ? ReplaceAlgo::Fifo_algo : selectAlgo(choice);
+}
+
 void runTests() {
     struct TestCase {
         ReplaceAlgo algo;
         int frames;
-        vector<int> refs;
+        vector<PageId> refs;
         string desc;
     };
 
@@ -267,12 +113,191 @@ void runTests() {
         auto results = simulate(algo, frames, refs);
         printResults(results);
     }
+
+    vector<PageId> rwRefs;
+    vector<AccessOp> rwOps;
+    parseRefs("1w 2 3w 4 1 5 2w 6 3 7w 8 2 4w 5 6 1", rwRefs, rwOps);
+    const vector<pair<ReplaceAlgo, int>> rwCases = {
+            {ReplaceAlgo::Clock_algo, 1},
+            {ReplaceAlgo::Clean_clock_algo, 1},
+            {ReplaceAlgo::Clean_clock_algo, 4},
+    };
+    for (const auto& [algo, cluster] : rwCases) {
+        cout << "\nTest: read/write references, " << algoName(algo) << " with 4 frames, write-back cluster "
+                << cluster << "\n";
+        printResults(simulate(algo, 4, rwRefs, rwOps, cluster));
+    }
+
+    vector<PageId> edgeRefs;
+    vector<AccessOp> edgeOps;
+    parseRefs("9223372036854775807w 9223372036854775806w 1 2", edgeRefs, edgeOps);
+    cout << "\nTest: write-back cluster at the top of the page id range, FIFO with 2 frames, cluster 4\n";
+    printResults(simulate(ReplaceAlgo::Fifo_algo, 2, edgeRefs, edgeOps, 4));
+
+    runMultiTests();
+    runPrefetchTests();
+    runShardsTests();
     cout << "\n===== Tests Finished =====\n\n";
 }
 
+void runMultiInteractive() {
+    MultiConfig cfg;
+    int processes;
+    int algoChoice;
+    int scopeChoice;
+    cout << "Enter process count, frame pool size and quantum: ";
+    if (!(cin >> processes >> cfg.poolFrames >> cfg.quantum) || processes <= 0 || cfg.poolFrames <= 0 ||
+        cfg.quantum <= 0) {
+        cout << "Invalid multi-process parameters.\n";
+        cin.clear();
+        cin.ignore(1024, '\n');
+        return;
+    }
+    cout << "Replacement algorithm (1) FIFO  2) OPT  3) LRU  7) CLOCK): ";
+    cin >> algoChoice;
+    cfg.algo = selectReadOnlyAlgo(algoChoice);
+    cout << "Scope (1) Local  2) Global): ";
+    cin >> scopeChoice;
+    cfg.scope = scopeChoice == 2 ? ReplaceScope::Global_scope : ReplaceScope::Local_scope;
+    if (cfg.scope == ReplaceScope::Local_scope) {
+        int allocChoice;
+        cout << "Allocation (1) Equal  2) Working-Set  3) PFF): ";
+        cin >> allocChoice;
+        cfg.alloc = allocChoice == 2   ? FrameAlloc::Working_set_alloc
+                    : allocChoice == 3 ? FrameAlloc::Pff_alloc
+                                       : FrameAlloc::Equal_alloc;
+        if (cfg.poolFrames < processes) {
+            cout << "Local scope needs at least one frame per process.\n";
+            return;
+        }
+    }
+    if (!cin) {
+        cin.clear();
+        cin.ignore(1024, '\n');
+        cout << "Invalid selection.\n";
+        return;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    vector<ProcessTrace> traces;
+    for (int pid = 1; pid <= processes; ++pid) {
+        cout << "Reference string of process " << pid << ":\n";
+        string line;
+        getline(cin, line);
+        istringstream iss(line);
+        ProcessTrace trace{pid, {}};
+        PageId value;
+        while (iss >> value) {
+            trace.refs.push_back(value);
+        }
+        if (trace.refs.empty()) {
+            cout << "Reference string cannot be empty.\n";
+            return;
+        }
+        traces.push_back(trace);
+    }
+
+    cout << "\nRunning " << scopeName(cfg.scope) << " " << algoName(cfg.algo);
+    if (cfg.scope == ReplaceScope::Local_scope) cout << " (" << frameAllocName(cfg.alloc) << " allocation)";
+    cout << " with " << cfg.poolFrames << " frames, quantum " << cfg.quantum << ".\n\n";
+    printMultiResults(simulateMulti(traces, cfg));
+    cout << "\n";
+}
+
+void runPrefetchInteractive() {
+    CostModel cost;
+    int algoChoice;
+    int frames;
+    cout << "Replacement algorithm (1) FIFO  2) OPT  3) LRU  7) CLOCK): ";
+    cin >> algoChoice;
+    cout << "Enter frame count: ";
+    cin >> frames;
+    cout << "Enter hit latency (ns), fault service time (ns) and queue depth: ";
+    cin >> cost.hitNs >> cost.faultNs >> cost.queueDepth;
+    if (!cin || frames <= 0 || cost.hitNs < 0 || cost.faultNs < 0 || cost.queueDepth <= 0) {
+        cout << "Invalid cost model parameters.\n";
+        cin.clear();
+        cin.ignore(1024, '\n');
+        return;
+    }
+
+    cout << "Enter reference string (space separated integers):\n";
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    string line;
+    getline(cin, line);
+    istringstream iss(line);
+    vector<PageId> refs;
+    PageId value;
+    while (iss >> value) {
+        refs.push_back(value);
+    }
+    if (refs.empty()) {
+        cout << "Reference string cannot be empty.\n";
+        return;
+    }
+
+    auto algo = selectReadOnlyAlgo(algoChoice);
+    cout << "\nReadahead sweep for " << algoName(algo) << " with " << frames << " frames on "
+            << refs.size() << " references.\n";
+    sweepReadahead(algo, frames, refs, cost, PrefetchConfig{}, {0, 1, 2, 4, 8, 16});
+    cout << "\n";
+}
+
+void runShardsInteractive() {
+    ShardsConfig cfg;
+    int algoChoice;
+    int modeChoice;
+    cout << "Replacement algorithm (1) FIFO  2) OPT  3) LRU  7) CLOCK): ";
+    cin >> algoChoice;
+    cout << "Sampling (1) Fixed-rate  2) Fixed-size): ";
+    cin >> modeChoice;
+    cout << "Enter sampling rate: ";
+    cin >> cfg.rate;
+    if (modeChoice == 2) {
+        cfg.mode = ShardsMode::Fixed_size;
+        cout << "Enter max sampled pages: ";
+        cin >> cfg.maxPages;
+    }
+    if (!cin || cfg.rate <= 0 || cfg.rate > 1 || cfg.maxPages == 0) {
+        cout << "Invalid sampling parameters.\n";
+        cin.clear();
+        cin.ignore(1024, '\n');
+        return;
+    }
+
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "Enter frame counts to evaluate (space separated):\n";
+    string line;
+    getline(cin, line);
+    istringstream sizesIn(line);
+    vector<int> sizes;
+    int value;
+    while (sizesIn >> value) {
+        if (value > 0) sizes.push_back(value);
+    }
+
+    cout << "Enter reference string (space separated integers):\n";
+    getline(cin, line);
+    istringstream refsIn(line);
+    vector<PageId> refs;
+    PageId page;
+    while (refsIn >> page) {
+        refs.push_back(page);
+    }
+    if (sizes.empty() || refs.empty()) {
+        cout << "Frame counts and reference string cannot be empty.\n";
+        return;
+    }
+
+    cout << "\n";
+    validateShards(selectReadOnlyAlgo(algoChoice), refs, sizes, cfg);
+    cout << "\n";
+}
+
 int main() {
     cout << "==== Page Replacement Simulator ====\n";
-    cout << "Algorithms: 1) FIFO  2) OPT  3) LRU  4) Run Tests\n";
+    cout << "Algorithms: 1) FIFO  2) OPT  3) LRU  4) Run Tests  5) Multi-process  6) Readahead\n"
+            << "            7) CLOCK  8) Clean-first CLOCK  9) SHARDS MRC\n";
     cout << "Enter 0 as algorithm choice to exit.\n\n";
 
     while (true) {
@@ -291,6 +316,18 @@ int main() {
             runTests();
             continue;
         }
+        if (algoChoice == 5) {
+            runMultiInteractive();
+            continue;
+        }
+        if (algoChoice == 6) {
+            runPrefetchInteractive();
+            continue;
+        }
+        if (algoChoice == 9) {
+            runShardsInteractive();
+            continue;
+        }
 
         cout << "Enter frame count: ";
         int frames;
@@ -301,15 +338,24 @@ int main() {
             continue;
         }
 
-        cout << "Enter reference string (space separated integers):\n";
+        cout << "Enter write-back cluster size (1 = no clustering): ";
+        int cluster;
+        if (!(cin >> cluster) || cluster <= 0) {
+            cout << "Invalid cluster size.\n";
+            cin.clear();
+            cin.ignore(1024, '\n');
+            continue;
+        }
+
+        cout << "Enter reference string (space separated pages, suffix w for writes, e.g. 1 2w 3):\n";
         cin.ignore(numeric_limits<streamsize>::max(), '\n');
         string line;
         getline(cin, line);
-        istringstream iss(line);
-        vector<int> refs;
-        int value;
-        while (iss >> value) {
-            refs.push_back(value);
+        vector<PageId> refs;
+        vector<AccessOp> ops;
+        if (!parseRefs(line, refs, ops)) {
+            cout << "Invalid reference string.\n";
+            continue;
         }
 
         if (refs.empty()) {
@@ -321,7 +367,7 @@ int main() {
         cout << "\nRunning " << algoName(algo) << " with "
                 << frames << " frames on " << refs.size() << " references.\n\n";
 
-        auto results = simulate(algo, frames, refs);
+        auto results = simulate(algo, frames, refs, ops, cluster);
         printResults(results);
         cout << "\n";
     }
@@ -0,0 +1,454 @@
+#ifndef PAGE_REPLACEMENT_HPP
+#define PAGE_REPLACEMENT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+enum class ReplaceAlgo {
+    Fifo_algo,
+    Opt_algo,
+    Lru_algo,
+    Clock_algo,
+    Clean_clock_algo,
+};
+
+enum class AccessOp {
+    Read_op,
+    Write_op,
+};
+
+using PageId = std::int64_t;
+
+// 页号加偏移，结果超出 PageId 范围时返回 nullopt
+inline std::optional<PageId> shiftPage(PageId page, PageId delta) {
+    using Limits = std::numeric_limits<PageId>;
+    if (delta > 0 && page > Limits::max() - delta) return std::nullopt;
+    if (delta < 0 && page < Limits::min() - delta) return std::nullopt;
+    return page + delta;
+}
+
+// 两页号之差 to - from，超出 PageId 范围时返回 nullopt
+inline std::optional<PageId> pageStride(PageId from, PageId to) {
+    using Limits = std::numeric_limits<PageId>;
+    if (from >= 0 ? to < Limits::min() + from : to > Limits::max() + from) return std::nullopt;
+    return to - from;
+}
+
+struct Frame {
+    PageId page = 0;
+    bool valid  = false;
+    bool dirty  = false;
+};
+
+struct AccessRes {
+    bool hit;
+    std::size_t victim;
+
+    AccessRes(const bool h, const std::size_t v) : hit(h), victim(v) {}
+    AccessRes(const bool h, const int intV) : hit(h), victim(static_cast<std::size_t>(intV)) {}
+};
+
+// 页号到帧号的开放寻址索引（线性探测、删除时后移），容量只与帧数相关，与页号范围无关
+class PageIndex {
+    std::vector<PageId> keys_;
+    std::vector<int> slots_;
+    std::size_t mask_;
+    int shift_;
+    std::size_t size_ = 0;
+
+    // Fibonacci 散列取乘积高位，连续页号也能均匀分布
+    std::size_t home(PageId page) const {
+        return static_cast<std::size_t>((static_cast<std::uint64_t>(page) * 0x9E3779B97F4A7C15ULL) >> shift_);
+    }
+
+public:
+    explicit PageIndex(int frameCount) : shift_(61) {
+        std::size_t capacity = 8;
+        while (capacity < 4 * static_cast<std::size_t>(std::max(frameCount, 0))) {
+            capacity <<= 1;
+            --shift_;
+        }
+        keys_.assign(capacity, 0);
+        slots_.assign(capacity, -1);
+        mask_ = capacity - 1;
+    }
+
+    int find(PageId page) const {
+        for (std::size_t i = home(page); slots_[i] >= 0; i = (i + 1) & mask_) {
+            if (keys_[i] == page) return slots_[i];
+        }
+        return -1;
+    }
+
+    void insert(PageId page, int slot) {
+        std::size_t i = home(page);
+        while (slots_[i] >= 0 && keys_[i] != page) i = (i + 1) & mask_;
+        if (slots_[i] < 0) ++size_;
+        keys_[i]  = page;
+        slots_[i] = slot;
+    }
+
+    void erase(PageId page) {
+        std::size_t i = home(page);
+        while (slots_[i] >= 0 && keys_[i] != page) i = (i + 1) & mask_;
+        if (slots_[i] < 0) return;
+        --size_;
+        for (std::size_t j = (i + 1) & mask_; slots_[j] >= 0; j = (j + 1) & mask_) {
+            std::size_t h = home(keys_[j]);
+            // 探测链上 h 不在 (i, j] 内的元素可以后移到空位 i
+            if (((j - h) & mask_) >= ((j - i) & mask_)) {
+                keys_[i]  = keys_[j];
+                slots_[i] = slots_[j];
+                i         = j;
+            }
+        }
+        slots_[i] = -1;
+    }
+
+    std::size_t size() const { return size_; }
+};
+
+// 驻留判断、空闲帧分配与索引维护统一在基类完成，各策略只记录命中/装入并选择牺牲帧
+class AlgoState {
+    PageIndex index_;
+
+protected:
+    virtual void onHit(int /*step*/, std::size_t /*slot*/) {}
+    virtual void onLoad(int /*step*/, std::size_t /*slot*/) {}
+    virtual std::size_t victim(int step, const std::vector<Frame>& frames, const std::vector<PageId>& ref) = 0;
+
+public:
+    explicit AlgoState(int frameCount) : index_(frameCount) {}
+    virtual ~AlgoState() = default;
+
+    AccessRes access(int step, PageId page, std::vector<Frame>& frames, const std::vector<PageId>& ref) {
+        if (int slot = index_.find(page); slot >= 0) {
+            onHit(step, static_cast<std::size_t>(slot));
+            return {true, -1};
+        }
+
+        std::size_t slot = index_.size();
+        if (slot >= frames.size()) {
+            slot = victim(step, frames, ref);
+            index_.erase(frames[slot].page);
+        }
+
+        frames[slot].page  = page;
+        frames[slot].valid = true;
+        index_.insert(page, static_cast<int>(slot));
+        onLoad(step, slot);
+        return {false, slot};
+    }
+
+    int frameOf(PageId page) const { return index_.find(page); }
+};
+
+class FifoState final : public AlgoState {
+    int nextIndex_;
+
+protected:
+    std::size_t victim(int /*step*/, const std::vector<Frame>& frames, const std::vector<PageId>& /*ref*/) override {
+        int victim = nextIndex_;
+        nextIndex_ = (nextIndex_ + 1) % static_cast<int>(frames.size());
+        return victim;
+    }
+
+public:
+    explicit FifoState(int frameCount) : AlgoState(frameCount), nextIndex_(0) {}
+};
+
+class LruState final : public AlgoState {
+    std::vector<int> lastUsed_;
+
+protected:
+    void onHit(int step, std::size_t slot) override { lastUsed_[slot] = step; }
+    void onLoad(int step, std::size_t slot) override { lastUsed_[slot] = step; }
+
+    std::size_t victim(int /*step*/, const std::vector<Frame>& frames, const std::vector<PageId>& /*ref*/) override {
+        std::size_t victim = 0;
+        int oldest         = lastUsed_[0];
+        for (std::size_t i = 1; i < frames.size(); ++i) {
+            if (lastUsed_[i] < oldest) {
+                oldest = lastUsed_[i];
+                victim = i;
+            }
+        }
+        return victim;
+    }
+
+public:
+    explicit LruState(int frameCount) : AlgoState(frameCount), lastUsed_(frameCount, -1) {}
+};
+
+class OptState final : public AlgoState {
+protected:
+    std::size_t victim(int step, const std::vector<Frame>& frames, const std::vector<PageId>& ref) override {
+        int victim          = -1;
+        int farthestNextUse = -1;
+
+        for (std::size_t i = 0; i < frames.size(); ++i) {
+            int nextUse = -1;
+            for (std::size_t j = step + 1; j < ref.size(); ++j) {
+                if (ref[j] == frames[i].page) {
+                    nextUse = static_cast<int>(j);
+                    break;
+                }
+            }
+
+            if (nextUse == -1) {
+                victim = static_cast<int>(i);
+                break;
+            }
+
+            if (nextUse > farthestNextUse) {
+                farthestNextUse = nextUse;
+                victim          = static_cast<int>(i);
+            }
+        }
+
+        if (victim == -1) {
+            victim = 0;
+        }
+        return static_cast<std::size_t>(victim);
+    }
+
+public:
+    explicit OptState(int frameCount) : AlgoState(frameCount) {}
+};
+
+class ClockState final : public AlgoState {
+    std::vector<bool> referenced_;
+    std::size_t hand_;
+
+protected:
+    void onHit(int /*step*/, std::size_t slot) override { referenced_[slot] = true; }
+    void onLoad(int /*step*/, std::size_t slot) override { referenced_[slot] = true; }
+
+    std::size_t victim(int /*step*/, const std::vector<Frame>& frames, const std::vector<PageId>& /*ref*/) override {
+        while (referenced_[hand_]) {
+            referenced_[hand_] = false;
+            hand_              = (hand_ + 1) % frames.size();
+        }
+
+        std::size_t victim = hand_;
+        hand_              = (hand_ + 1) % frames.size();
+        return victim;
+    }
+
+public:
+    explicit ClockState(int frameCount) : AlgoState(frameCount), referenced_(frameCount, false), hand_(0) {}
+};
+
+// 增强型二次机会：先找未访问且干净的页，再找未访问的脏页（此轮清除访问位），如此往复
+class CleanClockState final : public AlgoState {
+    std::vector<bool> referenced_;
+    std::size_t hand_;
+
+protected:
+    void onHit(int /*step*/, std::size_t slot) override { referenced_[slot] = true; }
+    void onLoad(int /*step*/, std::size_t slot) override { referenced_[slot] = true; }
+
+    std::size_t victim(int /*step*/, const std::vector<Frame>& frames, const std::vector<PageId>& /*ref*/) override {
+        const std::size_t n = frames.size();
+        std::size_t victim  = n;
+        while (victim == n) {
+            for (std::size_t k = 0; k < n && victim == n; ++k) {
+                std::size_t i = (hand_ + k) % n;
+                if (!referenced_[i] && !frames[i].dirty) victim = i;
+            }
+            for (std::size_t k = 0; k < n && victim == n; ++k) {
+                std::size_t i = (hand_ + k) % n;
+                if (!referenced_[i]) victim = i;
+                else referenced_[i] = false;
+            }
+        }
+
+        hand_ = (victim + 1) % n;
+        return victim;
+    }
+
+public:
+    explicit CleanClockState(int frameCount) : AlgoState(frameCount), referenced_(frameCount, false), hand_(0) {}
+};
+
+inline std::unique_ptr<AlgoState> newAlgoState(ReplaceAlgo algo, int frameCount) {
+    switch (algo) {
+        case ReplaceAlgo::Fifo_algo:
+            return std::make_unique<FifoState>(frameCount);
+        case ReplaceAlgo::Opt_algo:
+            return std::make_unique<OptState>(frameCount);
+        case ReplaceAlgo::Lru_algo:
+            return std::make_unique<LruState>(frameCount);
+        case ReplaceAlgo::Clock_algo:
+            return std::make_unique<ClockState>(frameCount);
+        case ReplaceAlgo::Clean_clock_algo:
+            return std::make_unique<CleanClockState>(frameCount);
+        default:
+            return std::make_unique<FifoState>(frameCount);
+    }
+}
+
+struct ResidentPage {
+    PageId page;
+    int loadedAt;
+    int lastUse;
+};
+
+// 以 frameCount 帧重建 AlgoState（回放不计缺页）：FIFO 按装入先后、其余按最近使用先后排序，
+// 保留排在最后的 frameCount 页并依次回放，resident 随之改为实际保留的页。
+// CLOCK 的访问位无法从外部恢复，回放后全部置位；脏位同样不保留
+inline std::unique_ptr<AlgoState> replayResident(ReplaceAlgo algo, int frameCount, std::vector<ResidentPage>& resident,
+                                                 std::vector<Frame>& frames, const std::vector<PageId>& ref) {
+    auto key = [algo](const ResidentPage& r) { return algo == ReplaceAlgo::Fifo_algo ? r.loadedAt : r.lastUse; };
+    std::sort(resident.begin(), resident.end(),
+              [&key](const ResidentPage& a, const ResidentPage& b) { return key(a) < key(b); });
+    const std::size_t keep = static_cast<std::size_t>(std::max(frameCount, 0));
+    if (resident.size() > keep) resident.erase(resident.begin(), resident.end() - keep);
+
+    frames.assign(keep, Frame{});
+    if (frameCount <= 0) return nullptr;
+    auto state = newAlgoState(algo, frameCount);
+    for (const auto& r : resident) state->access(key(r), r.page, frames, ref);
+    return state;
+}
+
+struct StepResult {
+    int step;
+    PageId page;
+    AccessOp op;
+    bool hit;
+    std::size_t victim;
+    int written;
+    std::vector<Frame> frames;
+};
+
+// 换出脏页时顺带写回与其页号相邻的驻留脏页，合并为一次 I/O；返回写回的页数
+inline int writeBackCluster(std::vector<Frame>& frames, const AlgoState& state, std::size_t victim, PageId evicted,
+                            int clusterPages) {
+    frames[victim].dirty = false;
+    int written          = 1;
+    for (int dir : {-1, 1}) {
+        for (auto page = shiftPage(evicted, dir); page && written < clusterPages; page = shiftPage(*page, dir)) {
+            int slot = state.frameOf(*page);
+            if (slot < 0 || !frames[slot].dirty) break;
+            frames[slot].dirty = false;
+            ++written;
+        }
+    }
+    return written;
+}
+
+// 访问后的脏页处理：缺页时先写回被换出的脏页（替换只改写 page/valid，dirty 仍属于旧页，
+// 其页号由 shadow 记录），写操作再置脏；返回写回的页数
+inline int trackDirty(std::vector<Frame>& frames, std::vector<PageId>& shadow, const AlgoState& state, PageId page,
+                      AccessOp op, const AccessRes& res, int clusterPages) {
+    int written      = 0;
+    std::size_t slot = res.hit ? static_cast<std::size_t>(state.frameOf(page)) : res.victim;
+    if (!res.hit) {
+        if (frames[slot].dirty) written = writeBackCluster(frames, state, slot, shadow[slot], clusterPages);
+        shadow[slot] = page;
+    }
+    if (op == AccessOp::Write_op) frames[slot].dirty = true;
+    return written;
+}
+
+inline std::vector<StepResult> simulate(ReplaceAlgo algo, int frameCount, const std::vector<PageId>& ref,
+                                       const std::vector<AccessOp>& ops, int clusterPages = 1) {
+    std::vector<Frame> frames(frameCount);
+    std::vector<PageId> shadow(frameCount, 0);
+    auto state = newAlgoState(algo, frameCount);
+    std::vector<StepResult> results;
+    results.reserve(ref.size());
+
+    for (std::size_t step = 0; step < ref.size(); ++step) {
+        const PageId page = ref[step];
+        const AccessOp op = step < ops.size() ? ops[step] : AccessOp::Read_op;
+        auto res          = state->access(static_cast<int>(step), page, frames, ref);
+        int written       = trackDirty(frames, shadow, *state, page, op, res, clusterPages);
+
+        results.push_back(StepResult{static_cast<int>(step), page, op, res.hit, res.victim, written, frames,});
+    }
+
+    return results;
+}
+
+inline std::vector<StepResult> simulate(ReplaceAlgo algo, int frameCount, const std::vector<PageId>& ref) {
+    return simulate(algo, frameCount, ref, {});
+}
+
+// 只统计命中次数、不保存逐步快照，供大规模引用串使用
+inline std::size_t countHits(ReplaceAlgo algo, int frameCount, const std::vector<PageId>& ref) {
+    std::vector<Frame> frames(frameCount);
+    auto state       = newAlgoState(algo, frameCount);
+    std::size_t hits = 0;
+    for (std::size_t step = 0; step < ref.size(); ++step) {
+        if (state->access(static_cast<int>(step), ref[step], frames, ref).hit) ++hits;
+    }
+    return hits;
+}
+
+struct WriteBackCounts {
+    std::size_t hits         = 0;
+    std::size_t writeIos     = 0;
+    std::size_t pagesWritten = 0;
+};
+
+// 与 simulate() 相同的脏页与写回处理，但只累计计数、不保存逐步快照，供大规模读写引用串使用
+inline WriteBackCounts countWriteBacks(ReplaceAlgo algo, int frameCount, const std::vector<PageId>& ref,
+                                       const std::vector<AccessOp>& ops, int clusterPages = 1) {
+    std::vector<Frame> frames(frameCount);
+    std::vector<PageId> shadow(frameCount, 0);
+    auto state = newAlgoState(algo, frameCount);
+    WriteBackCounts counts;
+    for (std::size_t step = 0; step < ref.size(); ++step) {
+        const AccessOp op = step < ops.size() ? ops[step] : AccessOp::Read_op;
+        auto res          = state->access(static_cast<int>(step), ref[step], frames, ref);
+        if (res.hit) ++counts.hits;
+        if (int written = trackDirty(frames, shadow, *state, ref[step], op, res, clusterPages)) {
+            ++counts.writeIos;
+            counts.pagesWritten += written;
+        }
+    }
+    return counts;
+}
+
+// 引用串记号：页号后可跟 r/w 表示读/写，缺省为读，例如 "1 2w 3r"
+inline bool parseRefs(const std::string& line, std::vector<PageId>& refs, std::vector<AccessOp>& ops) {
+    std::istringstream iss(line);
+    std::string token;
+    while (iss >> token) {
+        std::size_t pos = 0;
+        PageId page;
+        try {
+            page = std::stoll(token, &pos);
+        } catch (const std::exception&) {
+            return false;
+        }
+        std::string suffix = token.substr(pos);
+        if (suffix.empty() || suffix == "r" || suffix == "R") ops.push_back(AccessOp::Read_op);
+        else if (suffix == "w" || suffix == "W") ops.push_back(AccessOp::Write_op);
+        else return false;
+        refs.push_back(page);
+    }
+    return true;
+}
+
+inline std::string algoName(ReplaceAlgo algo) {
+    switch (algo) {
+        case ReplaceAlgo::Fifo_algo: return "FIFO";
+        case ReplaceAlgo::Opt_algo: return "OPT";
+        case ReplaceAlgo::Lru_algo: return "LRU";
+        case ReplaceAlgo::Clock_algo: return "CLOCK";
+        case ReplaceAlgo::Clean_clock_algo: return "Clean-first CLOCK";
+    }
+    return "Unknown";
+}
+
+#endif
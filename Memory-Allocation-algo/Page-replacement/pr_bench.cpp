@@ -0,0 +1,296 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "page_replacement.hpp"
+using namespace std;
+
+#ifndef PR_BENCH_BUILD_TYPE
+#define PR_BENCH_BUILD_TYPE ""
+#endif
+
+// 通过替换全局 operator new/delete 统计堆内存，每次测量前重置峰值
+namespace heap {
+atomic<size_t> current{0};
+atomic<size_t> peak{0};
+
+void resetPeak() { peak = current.load(); }
+} // namespace heap
+
+void* operator new(size_t size) {
+    void* p = malloc(size + sizeof(max_align_t));
+    if (!p) throw bad_alloc();
+    *static_cast<size_t*>(p) = size;
+    size_t now = heap::current += size;
+    size_t old = heap::peak.load();
+    while (now > old && !heap::peak.compare_exchange_weak(old, now)) {}
+    return static_cast<char*>(p) + sizeof(max_align_t);
+}
+
+void operator delete(void* p) noexcept {
+    if (!p) return;
+    void* base = static_cast<char*>(p) - sizeof(max_align_t);
+    heap::current -= *static_cast<size_t*>(base);
+    free(base);
+}
+
+void operator delete(void* p, size_t) noexcept { operator delete(p); }
+
+enum class Workload {
+    Uniform_load,
+    Zipf_load,
+    Loop_load,
+    Scan_load,
+    Phase_load,
+    Sparse_load,
+};
+
+const vector<Workload> allWorkloads = {
+        Workload::Uniform_load, Workload::Zipf_load, Workload::Loop_load,
+        Workload::Scan_load, Workload::Phase_load, Workload::Sparse_load,
+};
+
+const vector<ReplaceAlgo> allAlgos = {
+        ReplaceAlgo::Fifo_algo, ReplaceAlgo::Opt_algo, ReplaceAlgo::Lru_algo,
+        ReplaceAlgo::Clock_algo, ReplaceAlgo::Clean_clock_algo,
+};
+
+string workloadName(Workload w) {
+    switch (w) {
+        case Workload::Uniform_load: return "uniform";
+        case Workload::Zipf_load: return "zipf";
+        case Workload::Loop_load: return "loop";
+        case Workload::Scan_load: return "scan";
+        case Workload::Phase_load: return "phase";
+        case Workload::Sparse_load: return "sparse64";
+    }
+    return "unknown";
+}
+
+struct BenchConfig {
+    size_t minRefs    = 1000;
+    size_t maxRefs    = 100000;
+    size_t optMaxRefs = 10000;
+    int pages         = 16384;
+    int repeats       = 5;
+    double writeRatio = 0.3;
+    int clusterPages  = 4;
+    vector<int> frames{16, 64, 256};
+    string out;
+};
+
+// 固定种子生成，保证不同构建之间的引用串完全一致
+vector<PageId> generate(Workload w, size_t n, int pages) {
+    mt19937_64 rng(0x5EED + static_cast<unsigned>(w));
+    vector<PageId> ref;
+    ref.reserve(n);
+
+    switch (w) {
+        case Workload::Uniform_load: {
+            uniform_int_distribution<int> dist(0, pages - 1);
+            for (size_t i = 0; i < n; ++i) ref.push_back(dist(rng));
+            break;
+        }
+        case Workload::Zipf_load:
+        case Workload::Sparse_load: {
+            vector<double> cdf(pages);
+            double sum = 0.0;
+            for (int k = 0; k < pages; ++k) cdf[k] = sum += 1.0 / pow(k + 1.0, 0.99);
+            uniform_real_distribution<double> dist(0.0, sum);
+            for (size_t i = 0; i < n; ++i) {
+                ref.push_back(lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin());
+            }
+            // 把 Zipf 页号散布到 48 位虚拟页号空间，模拟稀疏的真实地址
+            if (w == Workload::Sparse_load) {
+                for (auto& page : ref) {
+                    auto x = static_cast<uint64_t>(page) * 0x9E3779B97F4A7C15ULL;
+                    page   = static_cast<PageId>((x ^ (x >> 29)) & ((1ULL << 48) - 1));
+                }
+            }
+            break;
+        }
+        case Workload::Loop_load: {
+            const int loop = min(pages, 1000);
+            for (size_t i = 0; i < n; ++i) ref.push_back(static_cast<int>(i % loop));
+            break;
+        }
+        case Workload::Scan_load:
+            for (size_t i = 0; i < n; ++i) ref.push_back(static_cast<int>(i % (static_cast<size_t>(pages) * 4)));
+            break;
+        case Workload::Phase_load: {
+            const int hot          = min(pages, 512);
+            const size_t phaseLen  = max<size_t>(n / 10, 1000);
+            uniform_int_distribution<int> dist(0, hot - 1);
+            for (size_t i = 0; i < n; ++i) {
+                int base = static_cast<int>((i / phaseLen) * 1000 % pages);
+                ref.push_back((base + dist(rng)) % pages);
+            }
+            break;
+        }
+    }
+    return ref;
+}
+
+// 写操作独立于页号按固定比例随机产生，使 Clean-first CLOCK 与写回聚簇有脏页可处理
+vector<AccessOp> generateOps(Workload w, size_t n, double writeRatio) {
+    mt19937_64 rng(0x0B5 + static_cast<unsigned>(w));
+    bernoulli_distribution isWrite(writeRatio);
+    vector<AccessOp> ops;
+    ops.reserve(n);
+    for (size_t i = 0; i < n; ++i) ops.push_back(isWrite(rng) ? AccessOp::Write_op : AccessOp::Read_op);
+    return ops;
+}
+
+struct BenchResult {
+    Workload workload;
+    size_t refs;
+    ReplaceAlgo algo;
+    int frames;
+    double nsPerRef;
+    size_t peakHeapBytes;
+    double hitRatio;
+    size_t writeIos;
+    size_t pagesWritten;
+};
+
+// 经 countWriteBacks() 计时，所有策略都走脏页跟踪与写回路径；
+// 先预热一次（同时统计峰值堆内存），再计时 repeats 次取中位数
+BenchResult measure(Workload w, const vector<PageId>& ref, const vector<AccessOp>& ops, ReplaceAlgo algo, int frames,
+                    const BenchConfig& cfg) {
+    heap::resetPeak();
+    const size_t base = heap::current.load();
+    auto counts       = countWriteBacks(algo, frames, ref, ops, cfg.clusterPages);
+    const size_t peak = heap::peak.load() - base;
+
+    vector<double> samples;
+    for (int i = 0; i < cfg.repeats; ++i) {
+        auto start = chrono::steady_clock::now();
+        countWriteBacks(algo, frames, ref, ops, cfg.clusterPages);
+        samples.push_back(chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+    }
+    nth_element(samples.begin(), samples.begin() + samples.size() / 2, samples.end());
+    const double median = samples[samples.size() / 2];
+
+    return BenchResult{
+            w, ref.size(), algo, frames, ref.empty() ? 0.0 : median / ref.size(), peak,
+            ref.empty() ? 0.0 : static_cast<double>(counts.hits) / ref.size(), counts.writeIos, counts.pagesWritten,
+    };
+}
+
+string toJson(const BenchConfig& cfg, const vector<BenchResult>& results) {
+    ostringstream oss;
+    oss << "{\n"
+            << "  \"benchmark\": \"pr_bench\",\n"
+            << "  \"build_type\": \"" << PR_BENCH_BUILD_TYPE << "\",\n"
+#ifdef NDEBUG
+            << "  \"assertions\": false,\n"
+#else
+            << "  \"assertions\": true,\n"
+#endif
+            << "  \"pages\": " << cfg.pages << ",\n"
+            << "  \"repeats\": " << cfg.repeats << ",\n"
+            << "  \"write_ratio\": " << cfg.writeRatio << ",\n"
+            << "  \"cluster_pages\": " << cfg.clusterPages << ",\n"
+            << "  \"opt_max_refs\": " << cfg.optMaxRefs << ",\n"
+            << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        oss << "    {\"workload\": \"" << workloadName(r.workload) << "\", \"refs\": " << r.refs
+                << ", \"algo\": \"" << algoName(r.algo) << "\", \"frames\": " << r.frames
+                << ", \"ns_per_ref\": " << r.nsPerRef << ", \"peak_heap_bytes\": " << r.peakHeapBytes
+                << ", \"hit_ratio\": " << r.hitRatio << ", \"write_ios\": " << r.writeIos
+                << ", \"pages_written\": " << r.pagesWritten << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    oss << "  ]\n}\n";
+    return oss.str();
+}
+
+void usage() {
+    cerr << "Usage: pr_bench [--min-refs N] [--max-refs N] [--opt-max-refs N] [--pages N]\n"
+            << "                [--frames a,b,c] [--repeats N] [--write-ratio F] [--cluster N] [--out FILE]\n"
+            << "Reference counts step by powers of ten from min to max (up to 100000000).\n"
+            << "Each configuration runs once to warm up, then reports the median of N timed runs (default 5).\n"
+            << "A fraction F of references are writes (default 0.3); dirty evictions write back up to N\n"
+            << "adjacent dirty pages in one I/O (default 4).\n";
+}
+
+bool parseArgs(int argc, char** argv, BenchConfig& cfg) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) return false;
+        string value = argv[++i];
+        try {
+            if (arg == "--min-refs") cfg.minRefs = stoull(value);
+            else if (arg == "--max-refs") cfg.maxRefs = stoull(value);
+            else if (arg == "--opt-max-refs") cfg.optMaxRefs = stoull(value);
+            else if (arg == "--pages") cfg.pages = stoi(value);
+            else if (arg == "--repeats") cfg.repeats = stoi(value);
+            else if (arg == "--write-ratio") cfg.writeRatio = stod(value);
+            else if (arg == "--cluster") cfg.clusterPages = stoi(value);
+            else if (arg == "--out") cfg.out = value;
+            else if (arg == "--frames") {
+                cfg.frames.clear();
+                istringstream iss(value);
+                string item;
+                while (getline(iss, item, ',')) cfg.frames.push_back(stoi(item));
+            } else return false;
+        } catch (const exception&) {
+            return false;
+        }
+    }
+    bool framesOk = !cfg.frames.empty() && all_of(cfg.frames.begin(), cfg.frames.end(), [](int f) { return f > 0; });
+    return framesOk && cfg.pages > 0 && cfg.repeats > 0 && cfg.writeRatio >= 0 &&
+           cfg.writeRatio <= 1 && cfg.clusterPages > 0 && cfg.minRefs > 0 && cfg.minRefs <= cfg.maxRefs;
+}
+
+int main(int argc, char** argv) {
+    BenchConfig cfg;
+    if (!parseArgs(argc, argv, cfg)) {
+        usage();
+        return 1;
+    }
+    if (string(PR_BENCH_BUILD_TYPE).empty()) {
+        cerr << "Warning: build type unknown, timings may come from an unoptimized build\n";
+    }
+
+    vector<BenchResult> results;
+    for (size_t n = cfg.minRefs; n <= cfg.maxRefs; n *= 10) {
+        for (Workload w : allWorkloads) {
+            const auto ref = generate(w, n, cfg.pages);
+            const auto ops = generateOps(w, n, cfg.writeRatio);
+            for (ReplaceAlgo algo : allAlgos) {
+                if (algo == ReplaceAlgo::Opt_algo && n > cfg.optMaxRefs) continue;
+                for (int frames : cfg.frames) {
+                    results.push_back(measure(w, ref, ops, algo, frames, cfg));
+                    const auto& r = results.back();
+                    cerr << workloadName(w) << " n=" << n << " " << algoName(algo) << " frames=" << frames
+                            << ": " << r.nsPerRef << " ns/ref, hit ratio " << r.hitRatio << ", write I/Os "
+                            << r.writeIos << "\n";
+                }
+            }
+        }
+        if (n > cfg.maxRefs / 10) break;
+    }
+
+    const string json = toJson(cfg, results);
+    if (cfg.out.empty()) {
+        cout << json;
+    } else {
+        ofstream file(cfg.out);
+        if (!file) {
+            cerr << "Cannot write " << cfg.out << "\n";
+            return 1;
+        }
+        file << json;
+    }
+    return 0;
+}
@@ -0,0 +1,248 @@
+#ifndef PREFETCH_HPP
+#define PREFETCH_HPP
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "page_replacement.hpp"
+
+// 请求调页代价模型与顺序/跨步预读
+
+struct CostModel {
+    double hitNs   = 100.0;
+    double faultNs = 5'000'000.0;
+    int queueDepth = 4;
+};
+
+struct PrefetchConfig {
+    int window    = 4;
+    int trigger   = 2;
+    int maxStride = 64;
+};
+
+struct PrefetchStats {
+    int refs            = 0;
+    int hits            = 0;
+    int faults          = 0;
+    int lateHits        = 0;
+    int demandReads     = 0;
+    int prefetchReads   = 0;
+    int usefulPrefetch  = 0;
+    int wastedPrefetch  = 0;
+    int pollutionMisses = 0;
+    double elapsedNs    = 0.0;
+
+    double effectiveAccessNs() const { return refs ? elapsedNs / refs : 0.0; }
+    double accuracy() const { return prefetchReads ? static_cast<double>(usefulPrefetch) / prefetchReads : 0.0; }
+    double coverage() const {
+        int wanted = usefulPrefetch + faults;
+        return wanted ? static_cast<double>(usefulPrefetch) / wanted : 0.0;
+    }
+};
+
+// 识别等跨步访问流：同一跨步连续出现 trigger 次后确认，随后给出预读候选页
+class StrideDetector {
+    PageId lastPage_   = 0;
+    PageId lastStride_ = 0;
+    int runLength_     = 0;
+    bool primed_       = false;
+
+public:
+    std::vector<PageId> observe(PageId page, const PrefetchConfig& cfg) {
+        std::vector<PageId> ahead;
+        if (primed_) {
+            // 跨步超出 PageId 范围时必然大于 maxStride，按 0 处理以打断当前访问流
+            PageId stride = pageStride(lastPage_, page).value_or(0);
+            if (stride != 0 && stride == lastStride_) ++runLength_;
+            else runLength_ = 1;
+            lastStride_ = stride;
+            if (stride != 0 && std::abs(stride) <= cfg.maxStride && runLength_ >= cfg.trigger) {
+                for (int k = 1; k <= cfg.window; ++k) {
+                    auto next = shiftPage(page, stride * k);
+                    if (!next) break;
+                    ahead.push_back(*next);
+                }
+            }
+        }
+        lastPage_ = page;
+        primed_   = true;
+        return ahead;
+    }
+};
+
+inline PrefetchStats simulatePrefetch(ReplaceAlgo algo, int frameCount, const std::vector<PageId>& ref,
+                                      const CostModel& cost, const PrefetchConfig& cfg) {
+    PrefetchStats stats;
+    if (frameCount <= 0 || cost.queueDepth <= 0) return stats;
+
+    std::vector<Frame> frames(frameCount);
+    std::vector<std::optional<PageId>> shadow(frameCount);
+    auto state = newAlgoState(algo, frameCount);
+    StrideDetector detector;
+
+    // 驻留判断以 AlgoState 为准，readyAt 只记录驻留页的就绪时刻
+    std::unordered_map<PageId, double> readyAt;
+    std::unordered_set<PageId> pending;
+    std::unordered_set<PageId> displaced;
+    std::vector<double> slotFree(cost.queueDepth, 0.0);
+    double now = 0.0;
+
+    auto issue = [&](double at) {
+        auto slot = std::min_element(slotFree.begin(), slotFree.end());
+        *slot     = std::max(at, *slot) + cost.faultNs;
+        return *slot;
+    };
+
+    // 经 AlgoState 装入一页，返回被换出的页号（命中或装入空闲帧时无换出）
+    auto load = [&](int step, PageId page) -> std::optional<PageId> {
+        auto [hit, victim] = state->access(step, page, frames, ref);
+        if (hit) return std::nullopt;
+        auto evicted   = shadow[victim];
+        shadow[victim] = page;
+        if (evicted) readyAt.erase(*evicted);
+        return evicted;
+    };
+
+    for (std::size_t step = 0; step < ref.size(); ++step) {
+        PageId page = ref[step];
+        bool hit    = state->frameOf(page) >= 0;
+        double at   = now;
+        ++stats.refs;
+
+        if (hit) {
+            ++stats.hits;
+            if (pending.erase(page)) ++stats.usefulPrefetch;
+            double ready = readyAt[page];
+            if (ready > now) {
+                ++stats.lateHits;
+                now = ready;
+            }
+            load(static_cast<int>(step), page);
+        } else {
+            ++stats.faults;
+            ++stats.demandReads;
+            if (displaced.erase(page)) ++stats.pollutionMisses;
+            double done = issue(now);
+            auto evicted = load(static_cast<int>(step), page);
+            if (evicted) {
+                if (pending.erase(*evicted)) ++stats.wastedPrefetch;
+                displaced.erase(*evicted);
+            }
+            readyAt[page] = done;
+            now           = done;
+        }
+        now += cost.hitNs;
+
+        for (PageId next : detector.observe(page, cfg)) {
+            if (state->frameOf(next) >= 0) continue;
+            displaced.erase(next);
+            double ready = issue(at);
+            auto evicted = load(static_cast<int>(step), next);
+            if (evicted) {
+                if (pending.erase(*evicted)) ++stats.wastedPrefetch;
+                else displaced.insert(*evicted);
+            }
+            readyAt[next] = ready;
+            pending.insert(next);
+            ++stats.prefetchReads;
+        }
+    }
+
+    stats.wastedPrefetch += static_cast<int>(pending.size());
+    stats.elapsedNs = now;
+    return stats;
+}
+
+inline void printPrefetchHeader() {
+    using std::cout;
+    using std::left;
+    using std::setw;
+    cout << left
+            << setw(8) << "Window"
+            << setw(8) << "Faults"
+            << setw(10) << "Prefetch"
+            << setw(8) << "Wasted"
+            << setw(6) << "Late"
+            << setw(8) << "I/Os"
+            << setw(10) << "Accuracy"
+            << setw(10) << "Coverage"
+            << setw(11) << "Pollution"
+            << "EAT (us)\n";
+    cout << std::string(89, '-') << "\n";
+}
+
+inline void printPrefetchRow(int window, const PrefetchStats& s) {
+    using std::cout;
+    using std::left;
+    using std::setw;
+    cout << left << std::fixed << std::setprecision(3)
+            << setw(8) << window
+            << setw(8) << s.faults
+            << setw(10) << s.prefetchReads
+            << setw(8) << s.wastedPrefetch
+            << setw(6) << s.lateHits
+            << setw(8) << s.demandReads + s.prefetchReads
+            << setw(10) << s.accuracy()
+            << setw(10) << s.coverage()
+            << setw(11) << s.pollutionMisses
+            << s.effectiveAccessNs() / 1000.0 << "\n";
+    cout.unsetf(std::ios::floatfield);
+    cout << std::setprecision(6);
+}
+
+// 预读窗口扫描：窗口 0 即关闭预读，作为基线
+inline void sweepReadahead(ReplaceAlgo algo, int frameCount, const std::vector<PageId>& ref, const CostModel& cost,
+                           PrefetchConfig cfg, const std::vector<int>& windows) {
+    std::cout << "Cost model: hit " << cost.hitNs << " ns, fault " << cost.faultNs
+            << " ns, queue depth " << cost.queueDepth << "\n\n";
+    printPrefetchHeader();
+    for (int window : windows) {
+        cfg.window = window;
+        printPrefetchRow(window, simulatePrefetch(algo, frameCount, ref, cost, cfg));
+    }
+}
+
+inline void runPrefetchTests() {
+    using std::cout;
+
+    std::vector<PageId> refs;
+    for (int p = 0; p < 24; ++p) refs.push_back(p);
+    for (int p = 100; p < 148; p += 3) refs.push_back(p);
+    for (int p : {7, 42, 3, 91, 42, 7, 60, 3}) refs.push_back(p);
+    for (int p = 200; p < 216; ++p) refs.push_back(p);
+
+    cout << "\nTest: readahead sweep, LRU with 8 frames on " << refs.size()
+            << " references (sequential, stride-3, random, sequential)\n";
+    sweepReadahead(ReplaceAlgo::Lru_algo, 8, refs, CostModel{}, PrefetchConfig{}, {0, 1, 2, 4, 8});
+
+    std::vector<PageId> negative;
+    for (int k = 0; k < 3; ++k) {
+        for (PageId p : {-1, -2, -3}) negative.push_back(p);
+    }
+    for (PageId p = -10; p > -34; --p) negative.push_back(p);
+
+    cout << "\nTest: readahead on negative page ids, LRU with 2 frames on " << negative.size()
+            << " references (cyclic, descending); exact hits " << countHits(ReplaceAlgo::Lru_algo, 2, negative) << "\n";
+    sweepReadahead(ReplaceAlgo::Lru_algo, 2, negative, CostModel{}, PrefetchConfig{}, {0, 1});
+
+    const std::vector<PageId> refetched = {2, 1, 4, 5, 6, 7, 8, 7, 5, 6, 7, 8, 2, 3};
+    cout << "\nTest: pollution after prefetched pages are refetched, LRU with 2 frames on " << refetched.size()
+            << " references\n";
+    sweepReadahead(ReplaceAlgo::Lru_algo, 2, refetched, CostModel{}, PrefetchConfig{}, {0, 2});
+
+    const PageId top    = std::numeric_limits<PageId>::max();
+    const PageId bottom = std::numeric_limits<PageId>::min();
+    const std::vector<PageId> edges = {top - 3, top - 2, top - 1, top, bottom + 3, bottom + 2, bottom + 1, bottom};
+    cout << "\nTest: strides at both ends of the page id range, LRU with 4 frames\n";
+    sweepReadahead(ReplaceAlgo::Lru_algo, 4, edges, CostModel{}, PrefetchConfig{}, {0, 4});
+}
+
+#endif
@@ -0,0 +1,376 @@
+#ifndef SHARDS_HPP
+#define SHARDS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "page_replacement.hpp"
+
+// SHARDS 空间哈希采样估计缺页率曲线
+
+enum class ShardsMode {
+    Fixed_rate,
+    Fixed_size,
+};
+
+struct ShardsConfig {
+    ShardsMode mode      = ShardsMode::Fixed_rate;
+    double rate          = 0.01;
+    std::size_t maxPages = 4096;
+};
+
+struct MrcPoint {
+    int frames;
+    double missRatio;
+};
+
+struct ShardsResult {
+    std::vector<MrcPoint> curve;
+    double rate              = 0.0;
+    std::size_t totalRefs    = 0;
+    std::size_t sampledRefs  = 0;   // 被采样器接受时即计数，固定容量模式下包括此后被淘汰页的引用
+    std::size_t sampledPages = 0;   // 结束时仍被采样的页数
+    double errorBound        = 1.0; // 启发式误差估计，见 shardsMrc()
+};
+
+constexpr std::uint64_t kShardsModulus = 1ULL << 24;
+
+inline std::uint64_t shardsHash(PageId page) {
+    std::uint64_t x = static_cast<std::uint64_t>(page) + 0x9E3779B97F4A7C15ULL;
+    x               = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x               = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return (x ^ (x >> 31)) % kShardsModulus;
+}
+
+// 按页号哈希决定是否采样；固定容量模式下超出 maxPages 时降低阈值并淘汰哈希最大的页
+class ShardsSampler {
+    ShardsConfig cfg_;
+    std::uint64_t threshold_;
+    std::set<std::pair<std::uint64_t, PageId>> tracked_;
+
+public:
+    explicit ShardsSampler(const ShardsConfig& cfg)
+        : cfg_(cfg),
+          threshold_(static_cast<std::uint64_t>(std::clamp(cfg.rate, 0.0, 1.0) * kShardsModulus)) {}
+
+    bool observe(PageId page, std::vector<PageId>& dropped) {
+        const std::uint64_t h = shardsHash(page);
+        if (h >= threshold_) return false;
+        tracked_.emplace(h, page);
+
+        if (cfg_.mode == ShardsMode::Fixed_size && tracked_.size() > std::max<std::size_t>(1, cfg_.maxPages)) {
+            threshold_ = tracked_.rbegin()->first;
+            while (!tracked_.empty() && tracked_.rbegin()->first >= threshold_) {
+                dropped.push_back(tracked_.rbegin()->second);
+                tracked_.erase(std::prev(tracked_.end()));
+            }
+        }
+        return h < threshold_;
+    }
+
+    std::uint64_t threshold() const { return threshold_; }
+    double rate() const { return static_cast<double>(threshold_) / kShardsModulus; }
+    std::size_t pages() const { return tracked_.size(); }
+};
+
+// 以最近访问时刻为下标的树状数组：重用距离即该时刻之后仍被标记的页数，O(log M) 求得（M 为采样页数）
+class ReuseDistanceTracker {
+    std::unordered_map<PageId, std::size_t> lastAccess_;
+    std::vector<int> tree_;
+    std::size_t clock_ = 0;
+
+    void add(std::size_t t, int delta) {
+        for (++t; t < tree_.size(); t += t & (~t + 1)) tree_[t] += delta;
+    }
+
+    int prefix(std::size_t t) const {
+        int sum = 0;
+        for (++t; t > 0; t -= t & (~t + 1)) sum += tree_[t];
+        return sum;
+    }
+
+    // 时刻用尽时按先后重新编号，容量取页数的两倍，内存不随引用数增长
+    void compact() {
+        std::vector<std::pair<std::size_t, PageId>> order;
+        order.reserve(lastAccess_.size());
+        for (const auto& [page, t] : lastAccess_) order.emplace_back(t, page);
+        std::sort(order.begin(), order.end());
+
+        tree_.assign(std::max<std::size_t>(64, 2 * order.size()) + 1, 0);
+        clock_ = 0;
+        for (const auto& [t, page] : order) {
+            lastAccess_[page] = clock_;
+            add(clock_++, 1);
+        }
+    }
+
+public:
+    // 返回自上次访问以来访问过的不同页数；首次访问返回 nullopt
+    std::optional<std::size_t> access(PageId page) {
+        if (clock_ + 1 >= tree_.size()) compact();
+        std::optional<std::size_t> distance;
+        auto it = lastAccess_.find(page);
+        if (it != lastAccess_.end()) {
+            distance = lastAccess_.size() - prefix(it->second);
+            add(it->second, -1);
+            it->second = clock_;
+        } else {
+            lastAccess_.emplace(page, clock_);
+        }
+        add(clock_++, 1);
+        return distance;
+    }
+
+    void forget(PageId page) {
+        auto it = lastAccess_.find(page);
+        if (it == lastAccess_.end()) return;
+        add(it->second, -1);
+        lastAccess_.erase(it);
+    }
+};
+
+// LRU：距离与计数都按当时采样率放大，只为每个待求帧数累计命中，不保存距离直方图；
+// 内存只随采样页数与帧数个数增长
+inline ShardsResult shardsLru(const std::vector<PageId>& ref, const std::vector<int>& sizes,
+                              const ShardsConfig& cfg) {
+    ShardsSampler sampler(cfg);
+    ReuseDistanceTracker tracker;
+    std::vector<double> hits(sizes.size(), 0.0);
+    std::vector<PageId> dropped;
+    double sampledWeight = 0.0;
+    ShardsResult result;
+
+    for (PageId page : ref) {
+        ++result.totalRefs;
+        dropped.clear();
+        bool sampled = sampler.observe(page, dropped);
+        for (PageId gone : dropped) tracker.forget(gone);
+        if (!sampled) continue;
+
+        ++result.sampledRefs;
+        const double weight = 1.0 / sampler.rate();
+        sampledWeight += weight;
+        auto depth = tracker.access(page);
+        if (!depth) continue;
+        const double distance = static_cast<double>(*depth) * weight;
+        for (std::size_t i = 0; i < sizes.size(); ++i) {
+            if (distance < sizes[i]) hits[i] += weight;
+        }
+    }
+
+    result.rate         = sampler.rate();
+    result.sampledPages = sampler.pages();
+
+    // SHARDS_adj：用总引用数与放大后采样引用数之差修正距离为 0 的命中，抵消热点页带来的采样偏差
+    double total  = std::max(static_cast<double>(result.totalRefs), 1.0);
+    double adjust = total - sampledWeight;
+
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        double adjusted = sizes[i] > 0 ? hits[i] + adjust : hits[i];
+        result.curve.push_back(MrcPoint{sizes[i], std::clamp(1.0 - adjusted / total, 0.0, 1.0)});
+    }
+    return result;
+}
+
+inline int shardsScaledFrames(int frames, double rate) {
+    return std::max(1, static_cast<int>(std::lround(frames * rate)));
+}
+
+// FIFO/CLOCK 等：每个帧数各跑一个 frames * rate 帧的缩小模拟，随采样流逐条推进。
+// 固定容量模式下阈值下降时按新采样率重建各模拟：丢弃不再采样的页，其余页经 replayResident() 回放。
+// 内存只随采样页数与帧数增长
+inline ShardsResult shardsMiniature(ReplaceAlgo algo, const std::vector<PageId>& ref, const std::vector<int>& sizes,
+                                    const ShardsConfig& cfg) {
+    struct Miniature {
+        std::vector<Frame> frames;
+        std::unique_ptr<AlgoState> state;
+        std::vector<int> loadedAt;
+        std::vector<int> lastUse;
+        double misses = 0.0;
+    };
+
+    ShardsSampler sampler(cfg);
+    std::vector<Miniature> sims(sizes.size());
+    const std::vector<PageId> noFuture;
+    std::vector<PageId> dropped;
+    double sampledWeight = 0.0;
+    int step             = 0;
+    ShardsResult result;
+
+    auto rebuild = [&] {
+        const std::uint64_t threshold = sampler.threshold();
+        for (std::size_t i = 0; i < sims.size(); ++i) {
+            auto& sim        = sims[i];
+            const int scaled = shardsScaledFrames(sizes[i], sampler.rate());
+
+            std::vector<ResidentPage> resident;
+            for (std::size_t slot = 0; slot < sim.frames.size(); ++slot) {
+                const auto& [page, valid, dirty] = sim.frames[slot];
+                if (valid && shardsHash(page) < threshold) {
+                    resident.push_back(ResidentPage{page, sim.loadedAt[slot], sim.lastUse[slot]});
+                }
+            }
+
+            sim.state = replayResident(algo, scaled, resident, sim.frames, noFuture);
+            sim.loadedAt.assign(scaled, 0);
+            sim.lastUse.assign(scaled, 0);
+            for (const auto& [page, loadedAt, lastUse] : resident) {
+                const int slot     = sim.state->frameOf(page);
+                sim.loadedAt[slot] = loadedAt;
+                sim.lastUse[slot]  = lastUse;
+            }
+        }
+    };
+
+    rebuild();
+    for (PageId page : ref) {
+        ++result.totalRefs;
+        dropped.clear();
+        bool sampled = sampler.observe(page, dropped);
+        if (!dropped.empty()) rebuild();
+        if (!sampled) continue;
+
+        ++result.sampledRefs;
+        const double weight = 1.0 / sampler.rate();
+        sampledWeight += weight;
+        for (auto& sim : sims) {
+            auto [hit, victim] = sim.state->access(step, page, sim.frames, noFuture);
+            if (!hit) {
+                sim.misses += weight;
+                sim.loadedAt[victim] = step;
+            }
+            sim.lastUse[sim.state->frameOf(page)] = step;
+        }
+        ++step;
+    }
+
+    result.rate         = sampler.rate();
+    result.sampledPages = sampler.pages();
+    for (std::size_t i = 0; i < sizes.size(); ++i) {
+        double ratio = sampledWeight > 0.0 ? sims[i].misses / sampledWeight : 1.0;
+        result.curve.push_back(MrcPoint{sizes[i], ratio});
+    }
+    return result;
+}
+
+// OPT 需要未来引用，无法流式模拟：先扫描一遍确定最终阈值，再把该阈值下的采样引用串整体保存在内存中模拟，
+// 内存随采样引用数增长
+inline ShardsResult shardsOpt(const std::vector<PageId>& ref, const std::vector<int>& sizes,
+                              const ShardsConfig& cfg) {
+    ShardsSampler sampler(cfg);
+    std::vector<PageId> dropped;
+    ShardsResult result;
+    for (PageId page : ref) {
+        ++result.totalRefs;
+        dropped.clear();
+        if (sampler.observe(page, dropped)) ++result.sampledRefs;
+    }
+
+    std::vector<PageId> pages;
+    for (PageId page : ref) {
+        if (shardsHash(page) < sampler.threshold()) pages.push_back(page);
+    }
+
+    result.rate         = sampler.rate();
+    result.sampledPages = sampler.pages();
+    for (int frames : sizes) {
+        std::size_t hits = countHits(ReplaceAlgo::Opt_algo, shardsScaledFrames(frames, result.rate), pages);
+        double ratio     = pages.empty() ? 1.0 : 1.0 - static_cast<double>(hits) / pages.size();
+        result.curve.push_back(MrcPoint{frames, ratio});
+    }
+    return result;
+}
+
+inline ShardsResult shardsMrc(ReplaceAlgo algo, const std::vector<PageId>& ref, const std::vector<int>& sizes,
+                              const ShardsConfig& cfg) {
+    ShardsResult result;
+    if (algo == ReplaceAlgo::Lru_algo) result = shardsLru(ref, sizes, cfg);
+    else if (algo == ReplaceAlgo::Opt_algo) result = shardsOpt(ref, sizes, cfg);
+    else result = shardsMiniature(algo, ref, sizes, cfg);
+
+    // 启发式估计，并非保证：把采样页当作独立的伯努利样本取二项分布 95% 最坏半宽，
+    // 忽略了页间访问频率差异与采样页之间的相关性
+    if (result.sampledPages > 0) result.errorBound = 1.96 * 0.5 / std::sqrt(static_cast<double>(result.sampledPages));
+    return result;
+}
+
+inline std::string shardsModeName(ShardsMode mode) {
+    return mode == ShardsMode::Fixed_size ? "fixed-size" : "fixed-rate";
+}
+
+// 与精确 countHits() 结果逐点对比，仅适用于可整体模拟的小规模引用串
+inline void validateShards(ReplaceAlgo algo, const std::vector<PageId>& ref, const std::vector<int>& sizes,
+                           const ShardsConfig& cfg) {
+    using std::cout;
+    using std::left;
+    using std::setw;
+
+    ShardsResult est = shardsMrc(algo, ref, sizes, cfg);
+    cout << algoName(algo) << ", " << shardsModeName(cfg.mode) << " sampling: rate " << est.rate
+            << ", sampled " << est.sampledRefs << "/" << est.totalRefs << " refs, "
+            << est.sampledPages << " pages\n\n";
+    cout << left
+            << setw(8) << "Frames"
+            << setw(12) << "Exact"
+            << setw(12) << "SHARDS"
+            << "Abs Error\n";
+    cout << std::string(45, '-') << "\n";
+
+    double sumError = 0.0;
+    double maxError = 0.0;
+    for (const auto& [frames, estimate] : est.curve) {
+        std::size_t hits = countHits(algo, frames, ref);
+        double exact     = ref.empty() ? 0.0 : 1.0 - static_cast<double>(hits) / ref.size();
+        double error = std::fabs(exact - estimate);
+        sumError += error;
+        maxError = std::max(maxError, error);
+        cout << left
+                << setw(8) << frames
+                << setw(12) << exact
+                << setw(12) << estimate
+                << error << "\n";
+    }
+
+    cout << "\nMean abs error: " << (est.curve.empty() ? 0.0 : sumError / est.curve.size())
+            << ", Max abs error: " << maxError
+            << ", heuristic 95% error bound: " << est.errorBound << "\n";
+}
+
+inline void runShardsTests() {
+    std::vector<PageId> refs;
+    unsigned seed = 12345;
+    for (int i = 0; i < 5000; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        int r = static_cast<int>((seed >> 8) % 1000);
+        refs.push_back(r < 700 ? r % 120 : 120 + r % 680);
+    }
+    const std::vector<int> sizes = {16, 32, 64, 128, 192};
+
+    ShardsConfig fixedRate;
+    fixedRate.rate = 0.25;
+    ShardsConfig fixedSize;
+    fixedSize.mode     = ShardsMode::Fixed_size;
+    fixedSize.rate     = 1.0;
+    fixedSize.maxPages = 160;
+
+    std::cout << "\nTest: SHARDS miss-ratio curves on " << refs.size() << " references over 800 pages\n";
+    validateShards(ReplaceAlgo::Lru_algo, refs, sizes, fixedRate);
+    std::cout << "\n";
+    validateShards(ReplaceAlgo::Lru_algo, refs, sizes, fixedSize);
+    std::cout << "\n";
+    validateShards(ReplaceAlgo::Clock_algo, refs, sizes, fixedRate);
+    std::cout << "\n";
+    validateShards(ReplaceAlgo::Clock_algo, refs, sizes, fixedSize);
+}
+
+#endif